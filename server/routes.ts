@@ -4,10 +4,19 @@ import { storage } from "./storage";
 import multer from "multer";
 import { spawn } from "child_process";
 import fs from "fs/promises";
+import os from "os";
 import path from "path";
 import { nanoid } from "nanoid";
 import { generateTimetableSchema, timetableFilterSchema } from "@shared/schema";
 
+// Matches the scheduler's own limit on settings per sweep
+const MAX_SWEEP_SETTINGS = 1024;
+// Sweeps may queue at most this many settings per core, so one sweep costs
+// a few single runs of wall time
+const MAX_SWEEP_SETTINGS_PER_CORE = 4;
+// Time budget for one solve; sweeps scale it by the solves each core runs
+const SCHEDULER_TIMEOUT_MS = 30000;
+
 // Configure multer for file uploads
 const upload = multer({
   dest: "uploads/",
@@ -68,6 +77,56 @@ export async function registerRoutes(app: Express): Promise<Server> {
     }
   });
 
+  app.post("/api/sweep", upload.fields([
+    { name: "dataset", maxCount: 1 },
+    { name: "config", maxCount: 1 },
+  ]), async (req, res) => {
+    const files = req.files as { [fieldname: string]: Express.Multer.File[] } | undefined;
+    const datasetPath = files?.dataset?.[0]?.path;
+    const configPath = files?.config?.[0]?.path;
+    try {
+      if (!datasetPath || !configPath) {
+        return res.status(400).json({ message: "Both dataset and config files are required" });
+      }
+
+      // Comma list ("0,5,10") or range ("0:20:2.5"), passed straight to the scheduler
+      const morningWeights = String(req.body.morningWeights ?? "0:15:5");
+      const distributionPenalties = String(req.body.distributionPenalties ?? "2");
+      const select = String(req.body.select ?? "pareto");
+      const weights = summarizeSweepValues(morningWeights);
+      const penalties = summarizeSweepValues(distributionPenalties);
+      if (weights === null || penalties === null) {
+        return res.status(400).json({ message: "Sweep values must be a comma list or start:end:step range" });
+      }
+      if (weights.max > 20) {
+        return res.status(400).json({ message: "Morning weights must be between 0 and 20" });
+      }
+      const settings = weights.count * penalties.count;
+      const cores = Math.max(1, os.cpus().length);
+      const maxSettings = Math.min(MAX_SWEEP_SETTINGS, cores * MAX_SWEEP_SETTINGS_PER_CORE);
+      if (settings > maxSettings) {
+        return res.status(400).json({ message: `Sweep has ${settings} settings; at most ${maxSettings} are allowed on this server` });
+      }
+      if (!/^(pareto|all|none|[0-9,]+)$/.test(select)) {
+        return res.status(400).json({ message: "Invalid sweep selection" });
+      }
+
+      // Settings are solved in parallel, one per core
+      const rounds = Math.ceil(settings / cores);
+      const stdout = await runScheduler(datasetPath, configPath, [
+        "--sweep", morningWeights, distributionPenalties, select,
+      ], SCHEDULER_TIMEOUT_MS * rounds);
+      res.json(JSON.parse(stdout));
+    } catch (error) {
+      res.status(500).json({ message: error instanceof Error ? error.message : "Internal server error" });
+    } finally {
+      await Promise.all([
+        datasetPath ? fs.unlink(datasetPath).catch(() => {}) : Promise.resolve(),
+        configPath ? fs.unlink(configPath).catch(() => {}) : Promise.resolve(),
+      ]);
+    }
+  });
+
   app.get("/api/schedule/:sessionId", async (req, res) => {
     try {
       const { sessionId } = req.params;
@@ -135,7 +194,7 @@ export async function registerRoutes(app: Express): Promise<Server> {
 // }
 async function compileCppScheduler(): Promise<void> {
   return new Promise((resolve, reject) => {
-    const compile = spawn("g++", ["timetable_scheduler_greedy.cpp", "-o", "scheduler"]);
+    const compile = spawn("g++", ["timetable_scheduler_greedy.cpp", "-pthread", "-o", "scheduler"]);
 
     compile.stderr.on("data", (data) => {
       console.error("Compiler error:", data.toString());
@@ -163,7 +222,7 @@ async function processSchedulerFiles(
   morningWeight: number = 5.0
 ): Promise<void> {
   try {
-    const stdout = await runScheduler(datasetPath, configPath, morningWeight);
+    const stdout = await runScheduler(datasetPath, configPath, [morningWeight.toString()]);
     const result = JSON.parse(stdout) as {
       timetable: any[];
       conflicts: { subject: string; unscheduledHours: number ; suggestion?: string;}[] // ✅ add this field
@@ -220,10 +279,11 @@ async function processSchedulerFiles(
 async function runScheduler(
   datasetPath: string,
   configPath: string,
-  morningWeight: number
+  extraArgs: string[],
+  timeoutMs: number = SCHEDULER_TIMEOUT_MS
 ): Promise<string> {
   return new Promise((resolve, reject) => {
-    const scheduler = spawn("./scheduler", [datasetPath, configPath, morningWeight.toString()]);
+    const scheduler = spawn("./scheduler", [datasetPath, configPath, ...extraArgs]);
     let stdout = "", stderr = "";
 
     scheduler.stdout?.on("data", (data) => { stdout += data.toString(); });
@@ -240,10 +300,27 @@ async function runScheduler(
     setTimeout(() => {
       scheduler.kill();
       reject(new Error("Scheduler execution timed out"));
-    }, 30000);
+    }, timeoutMs);
   });
 }
 
+// Count and largest value of a sweep axis, or null if it is not a valid list/range
+function summarizeSweepValues(spec: string): { count: number; max: number } | null {
+  const number = /^\d+(\.\d+)?$/;
+  if (spec.includes(":")) {
+    const fields = spec.split(":");
+    if (fields.length !== 3 || !fields.every((f) => number.test(f))) return null;
+    const [start, end, step] = fields.map(Number);
+    if (step <= 0 || end < start) return null;
+    const count = Math.floor((end - start) / step + 1e-9) + 1;
+    if (!Number.isFinite(count)) return null;
+    return { count, max: start + (count - 1) * step };
+  }
+  const values = spec.split(",").filter((v) => v !== "");
+  if (values.length === 0 || !values.every((v) => number.test(v))) return null;
+  return { count: values.length, max: Math.max(...values.map(Number)) };
+}
+
 function calculateStats(timetable: any[]): any {
   const subjects = new Set<string>();
   const teachers = new Set<string>();
@@ -5,6 +5,16 @@
 #include <fstream>
 #include <sstream>
 #include <tuple>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <stdexcept>
+#include <cmath>
+#include <map>
 
 
 // Struct for a subject
@@ -35,14 +45,201 @@ struct Conflict {
 };
 
 
+// Summary of every candidate score seen during a solve
+struct HeatmapStats {
+    long long count = 0;
+    double min = 0.0;
+    double max = 0.0;
+    double sum = 0.0;
+
+    void add(double score) {
+        if (count == 0 || score < min) min = score;
+        if (count == 0 || score > max) max = score;
+        sum += score;
+        ++count;
+    }
+    void merge(const HeatmapStats& other) {
+        if (other.count == 0) return;
+        if (count == 0 || other.min < min) min = other.min;
+        if (count == 0 || other.max > max) max = other.max;
+        sum += other.sum;
+        count += other.count;
+    }
+    double mean() const { return count > 0 ? sum / count : 0.0; }
+};
+
 // Result struct: scheduled slots + conflicts
 struct ScheduleResult {
     std::vector<Slot> timetable;
     std::vector<Conflict> conflicts;
     // 👈 added for heatmap
     std::vector<std::tuple<std::string, std::string, std::string, double>> heatmap;
+    HeatmapStats heatmapStats;
+    std::vector<int> morningDistribution;  // morning slots used per day
+    int unscheduledHours = 0;              // sum over per-subject conflicts
+};
+
+// Per-run tuning knobs
+struct SolveSettings {
+    double morningWeight = 5.0;
+    double distributionPenalty = 2.0;
+    bool recordHeatmap = true;   // keep every candidate score (single runs only)
+    bool verbose = true;         // per-subject warnings on stderr
+};
+
+// Rooms of each type available in every period
+struct RoomCapacity {
+    int lab = 0;        // room name contains "Lab"
+    int classroom = 0;  // every other room
+};
+
+// Sessions already placed in one (day, time) period, by the room type they need
+struct PeriodLoad {
+    int lab = 0;        // "Lab" subjects
+    int classroom = 0;  // "Theory" subjects
+    int total = 0;      // all subjects, including ones that fit either type
+};
+
+// Teachers and semesters already booked in each period, by interned id,
+// so a candidate check does not have to scan the timetable. Each cell holds
+// the timetable index of the first booking, or -1 when free.
+struct PeriodBookings {
+    int teachers;
+    int semesters;
+    std::vector<int> teacherFirst;
+    std::vector<int> semesterFirst;
+
+    PeriodBookings(int periods, int teachers, int semesters)
+        : teachers(teachers), semesters(semesters),
+          teacherFirst((size_t)periods * teachers, -1),
+          semesterFirst((size_t)periods * semesters, -1) {}
+
+    int teacherAt(int period, int teacher) const { return teacherFirst[(size_t)period * teachers + teacher]; }
+    int semesterAt(int period, int semester) const { return semesterFirst[(size_t)period * semesters + semester]; }
+    void book(int period, int teacher, int semester, int entry) {
+        int& t = teacherFirst[(size_t)period * teachers + teacher];
+        int& s = semesterFirst[(size_t)period * semesters + semester];
+        if (t < 0) t = entry;
+        if (s < 0) s = entry;
+    }
+};
+
+// Parsed, sorted input shared read-only by every solve
+struct SchedulerInput {
+    std::vector<Subject> subjects;   // already in scheduling order
+    std::vector<std::string> rooms;
+    RoomCapacity capacity;
+    std::vector<int> teacherOf;      // interned teacher id per subject
+    std::vector<int> semesterOf;     // interned semester id per subject
+    int teacherCount = 0;
+    int semesterCount = 0;
+    int days_per_week = 5;
+    int hours_per_day = 6;
+    int overflowHours = 0;           // required hours beyond total capacity
 };
 
+// Small fixed-size worker pool. parallelFor hands out indices from a shared
+// counter, so idle workers keep pulling items until the range is drained.
+// The calling thread takes part; calls must not be nested. If an item throws,
+// the remaining items are skipped and the first exception is rethrown to the
+// caller once every worker has stopped.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threads) {
+        for (unsigned i = 1; i < threads; ++i)
+            workers.emplace_back([this] { workerLoop(); });
+    }
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& w : workers) w.join();
+    }
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return (unsigned)workers.size() + 1; }
+
+    template <typename Fn>
+    void parallelFor(int count, Fn&& fn) {
+        if (count <= 0) return;
+        if (workers.empty() || count == 1) {
+            for (int i = 0; i < count; ++i) fn(i);
+            return;
+        }
+        using F = typename std::remove_reference<Fn>::type;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            jobCtx = const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+            jobCall = [](void* ctx, int i) { (*static_cast<F*>(ctx))(i); };
+            jobCount = count;
+            jobError = nullptr;
+            next = 0;
+            active = workers.size();
+            ++generation;
+        }
+        wake.notify_all();
+        runItems();
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            done.wait(lock, [this] { return active == 0; });
+            jobCtx = nullptr;
+            jobCall = nullptr;
+            error = jobError;
+            jobError = nullptr;
+        }
+        if (error) std::rethrow_exception(error);
+    }
+
+private:
+    void runItems() {
+        try {
+            for (int i = next++; i < jobCount; i = next++) jobCall(jobCtx, i);
+        } catch (...) {
+            next = jobCount;  // stop handing out items
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!jobError) jobError = std::current_exception();
+        }
+    }
+    void workerLoop() {
+        unsigned long seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            runItems();
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                --active;
+            }
+            done.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::mutex mtx;
+    std::condition_variable wake, done;
+    void* jobCtx = nullptr;
+    void (*jobCall)(void*, int) = nullptr;
+    int jobCount = 0;
+    std::exception_ptr jobError;
+    std::atomic<int> next{0};
+    size_t active = 0;
+    unsigned long generation = 0;
+    bool stopping = false;
+};
+
+unsigned defaultThreadCount() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n > 0 ? n : 1;
+}
+
 // Read rooms from config file (CSV with header "resource_type,value")
 std::vector<std::string> getRooms(const std::string& config_filename, int& days_per_week, int& hours_per_day) {
     std::vector<std::string> rooms;
@@ -119,24 +316,47 @@ std::vector<Subject> readSubjects(const std::string& filename) {
     return subjects;
 }
 
-// Check if a slot is valid (no teacher, semester, or room conflict at same day/time)
-// Also enforce labs in lab rooms (room name contains "Lab")
-bool isValidSlot(const Subject& sub, const Slot& slot, const std::vector<Slot>& timetable) {
-    for (const auto& assigned : timetable) {
-        if (assigned.day == slot.day && assigned.time == slot.time) {
-            if (assigned.teacher == sub.teacher) return false; // Teacher conflict
-            if (assigned.semester == sub.semester) return false; // Semester conflict
-            if (assigned.room == slot.room) return false; // Room conflict
-        }
-    }
-   // Enforce room-type match: Labs only in "Lab", Theory only in "Classroom"
-if (sub.type == "Lab" && slot.room.find("Lab") == std::string::npos) {
-    return false; // Lab must be in a Lab room
+bool isLabRoom(const std::string& room) {
+    return room.find("Lab") != std::string::npos;
+}
+
+// Enforce room-type match: Labs only in "Lab", Theory only in "Classroom"
+bool roomFits(const Subject& sub, const std::string& room) {
+    if (sub.type == "Lab") return isLabRoom(room);
+    if (sub.type == "Theory") return !isLabRoom(room);
+    return true;
+}
+
+// Check if some room of the right type is still free in a period.
+// Labs <= lab rooms, theory <= classrooms and total <= all rooms is exactly
+// the condition for a full room assignment to exist (Hall's theorem).
+bool hasRoomFor(const Subject& sub, const PeriodLoad& load, const RoomCapacity& cap) {
+    if (load.total >= cap.lab + cap.classroom) return false;
+    if (sub.type == "Lab") return load.lab < cap.lab;
+    if (sub.type == "Theory") return load.classroom < cap.classroom;
+    return true;
 }
-if (sub.type == "Theory" && slot.room.find("Lab") != std::string::npos) {
-    return false; // Theory should not be placed in a Lab room
+
+// Room type a subject needs, used as the heatmap's room column
+std::string roomTypeLabel(const Subject& sub) {
+    if (sub.type == "Lab") return "Lab";
+    if (sub.type == "Theory") return "Classroom";
+    return "Any";
+}
+
+void addToPeriod(const Subject& sub, PeriodLoad& load) {
+    if (sub.type == "Lab") ++load.lab;
+    else if (sub.type == "Theory") ++load.classroom;
+    ++load.total;
 }
 
+// Check if a period is valid (no teacher or semester conflict at same day/time,
+// and a room of the right type left). Concrete rooms are assigned later.
+bool isValidPeriod(const Subject& sub, int teacher, int semester, int period,
+                   const PeriodBookings& bookings, const PeriodLoad& load, const RoomCapacity& cap) {
+    if (!hasRoomFor(sub, load, cap)) return false; // Room conflict
+    if (bookings.teacherAt(period, teacher) >= 0) return false; // Teacher conflict
+    if (bookings.semesterAt(period, semester) >= 0) return false; // Semester conflict
     return true;
 }
 
@@ -144,10 +364,6 @@ if (sub.type == "Theory" && slot.room.find("Lab") != std::string::npos) {
 struct SlotScore {
     Slot slot;
     double score;
-    // Sort descending by score
-    bool operator<(const SlotScore& other) const {
-        return score > other.score;
-    }
 };
 struct SlotFailureReasons {//conflict reasons
     int teacherConflict = 0;
@@ -207,46 +423,34 @@ std::string heatmapToJsonArray(const std::vector<std::tuple<std::string, std::st
     return json;
 }
 //for reason of conflict
-SlotFailureReasons analyzeSlotFailures(const Subject& sub, const std::vector<Slot>& timetable, const std::vector<std::string>& rooms,int days_per_week,int hours_per_day) {
+SlotFailureReasons analyzeSlotFailures(const Subject& sub, int teacher, int semester, const std::vector<std::string>& rooms,
+                                       const PeriodBookings& bookings, const std::vector<PeriodLoad>& loads,
+                                       const RoomCapacity& cap, int days_per_week, int hours_per_day) {
     SlotFailureReasons stats;
+    // Room type only depends on the room, and the timetable checks only on the period
+    int fitting = 0;
+    for (const auto& room : rooms) {
+        if (roomFits(sub, room)) ++fitting;
+    }
+    int mismatched = (int)rooms.size() - fitting;
+
     for (int day = 0; day < days_per_week; ++day) {
         for (int time = 0; time < hours_per_day; ++time) {
-            for (const auto& room : rooms) {
-                ++stats.totalChecked;
-                bool failed = false;
-
-                // Check room type
-                if (sub.type == "Lab" && room.find("Lab") == std::string::npos) {
-                    ++stats.roomTypeMismatch;
-                    failed = true;
-                }
-                if (sub.type == "Theory" && room.find("Lab") != std::string::npos) {
-                    ++stats.roomTypeMismatch;
-                    failed = true;
-                }
-
-                if (failed) continue;
+            stats.totalChecked += (int)rooms.size();
+            stats.roomTypeMismatch += mismatched;
 
-                // Check timetable conflicts
-                for (const auto& assigned : timetable) {
-                    if (assigned.day == day && assigned.time == time) {
-                        if (assigned.teacher == sub.teacher) {
-                            ++stats.teacherConflict;
-                            failed = true;
-                            break;
-                        }
-                        if (assigned.semester == sub.semester) {
-                            ++stats.semesterConflict;
-                            failed = true;
-                            break;
-                        }
-                        if (assigned.room == room) {
-                            ++stats.roomConflict;
-                            failed = true;
-                            break;
-                        }
-                    }
-                }
+            // Check timetable conflicts; the earliest clashing entry names the reason
+            int period = day * hours_per_day + time;
+            int teacherEntry = bookings.teacherAt(period, teacher);
+            int semesterEntry = bookings.semesterAt(period, semester);
+            if (teacherEntry >= 0 && (semesterEntry < 0 || teacherEntry <= semesterEntry)) {
+                stats.teacherConflict += fitting;
+            } else if (semesterEntry >= 0) {
+                stats.semesterConflict += fitting;
+            } else if (!hasRoomFor(sub, loads[period], cap)) {
+                // Rooms are interchangeable within a type, so a room only
+                // blocks the subject when its whole type is used up
+                stats.roomConflict += fitting;
             }
         }
     }
@@ -254,48 +458,163 @@ SlotFailureReasons analyzeSlotFailures(const Subject& sub, const std::vector<Slo
     return stats;
 }
 
+// Try to give session `s` a room, re-seating earlier sessions along an
+// augmenting path if needed (Kuhn's algorithm). Locked rooms are left alone.
+bool augmentRoom(int s, const std::vector<std::vector<int>>& fits, const std::vector<char>& locked,
+                 std::vector<int>& roomOf, std::vector<int>& ownerOf, std::vector<char>& visited) {
+    for (int r : fits[s]) {
+        if (visited[r] || locked[r]) continue;
+        visited[r] = 1;
+        if (ownerOf[r] < 0 || augmentRoom(ownerOf[r], fits, locked, roomOf, ownerOf, visited)) {
+            roomOf[s] = r;
+            ownerOf[r] = s;
+            return true;
+        }
+    }
+    return false;
+}
 
+// Assign concrete rooms per (day, time) with a bipartite matching of sessions
+// to rooms of a fitting type. Rooms are tried alphabetically. A session
+// continuing from the previous hour keeps its room unless the rest of the
+// period cannot be seated otherwise. `placedBy[i]` is the subject of timetable[i].
+void assignRooms(std::vector<Slot>& timetable, const std::vector<const Subject*>& placedBy,
+                 const std::vector<std::string>& rooms, int days_per_week, int hours_per_day) {
+    std::vector<int> roomOrder(rooms.size());
+    for (size_t i = 0; i < rooms.size(); ++i) roomOrder[i] = (int)i;
+    std::sort(roomOrder.begin(), roomOrder.end(),
+              [&](int a, int b) { return rooms[a] < rooms[b]; });
 
-// Greedy algorithm to schedule timetable with morning preference and conflict tracking
-ScheduleResult scheduleTimetable(std::vector<Subject>& subjects, const std::string& config_filename, double morningWeight = 5.0) {
-    ScheduleResult result;
-    auto& timetable = result.timetable;
-    auto& conflicts = result.conflicts;
-    // 👈 added for heatmap
-    std::vector<std::tuple<std::string, std::string, std::string, double>> heatmapData;
+    std::vector<std::vector<int>> byPeriod(days_per_week * hours_per_day);
+    for (size_t i = 0; i < timetable.size(); ++i) {
+        const Slot& slot = timetable[i];
+        if (slot.day >= 0 && slot.day < days_per_week && slot.time >= 0 && slot.time < hours_per_day)
+            byPeriod[slot.day * hours_per_day + slot.time].push_back((int)i);
+    }
 
+    for (int day = 0; day < days_per_week; ++day) {
+        for (int time = 0; time < hours_per_day; ++time) {
+            const std::vector<int>& sessions = byPeriod[day * hours_per_day + time];
+            if (sessions.empty()) continue;
 
-    // Define days and times
-    std::vector<std::string> days = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday"};
-    std::vector<std::string> times = {"9AM", "10AM", "11AM", "12PM", "1PM", "2PM"};
-    int days_per_week = (int)days.size();
-    int hours_per_day = (int)times.size();
-    
-    // Load rooms
-    std::vector<std::string> rooms = getRooms(config_filename,days_per_week,hours_per_day);
-    if (rooms.empty()) {
+            int n = (int)sessions.size();
+            std::vector<std::vector<int>> fits(n);
+            std::vector<int> preferred(n, -1);
+            for (int s = 0; s < n; ++s) {
+                const Subject* sub = placedBy[sessions[s]];
+                for (int r : roomOrder) {
+                    if (roomFits(*sub, rooms[r])) fits[s].push_back(r);
+                }
+                if (time > 0) {
+                    for (int prev : byPeriod[day * hours_per_day + time - 1]) {
+                        if (placedBy[prev] != sub) continue;
+                        for (int r : fits[s]) {
+                            if (rooms[r] == timetable[prev].room) preferred[s] = r;
+                        }
+                    }
+                }
+            }
+
+            // Continuing sessions keep their room; those rooms are locked
+            std::vector<int> roomOf(n, -1), ownerOf(rooms.size(), -1);
+            std::vector<char> locked(rooms.size(), 0);
+            for (int s = 0; s < n; ++s) {
+                if (preferred[s] >= 0 && ownerOf[preferred[s]] < 0) {
+                    roomOf[s] = preferred[s];
+                    ownerOf[preferred[s]] = s;
+                    locked[preferred[s]] = 1;
+                }
+            }
+            // Greedy seed: the first free fitting room
+            for (int s = 0; s < n; ++s) {
+                if (roomOf[s] >= 0) continue;
+                for (int r : fits[s]) {
+                    if (ownerOf[r] < 0) {
+                        roomOf[s] = r;
+                        ownerOf[r] = s;
+                        break;
+                    }
+                }
+            }
+            // Augment whatever the seed left unmatched around the locked rooms.
+            // If that fails, release locks one at a time: subjects that fit any
+            // room first, then Theory, Labs last. A continuing Lab or Theory
+            // session can always keep its room (whoever needs that room fits
+            // any other room of the same type), so in practice only the
+            // flexible sessions move.
+            auto releaseRank = [&](int s) {
+                const std::string& type = placedBy[sessions[s]]->type;
+                return type == "Lab" ? 2 : type == "Theory" ? 1 : 0;
+            };
+            for (int s = 0; s < n; ++s) {
+                if (roomOf[s] >= 0) continue;
+                std::vector<int> held;
+                for (int r : roomOrder) {
+                    locked[r] = ownerOf[r] >= 0 && preferred[ownerOf[r]] == r;
+                    if (locked[r]) held.push_back(r);
+                }
+                std::stable_sort(held.begin(), held.end(), [&](int a, int b) {
+                    return releaseRank(ownerOf[a]) < releaseRank(ownerOf[b]);
+                });
+                for (size_t k = 0; ; ++k) {
+                    std::vector<char> visited(rooms.size(), 0);
+                    if (augmentRoom(s, fits, locked, roomOf, ownerOf, visited)) break;
+                    if (k == held.size()) break;
+                    locked[held[k]] = 0;
+                }
+            }
+
+            for (int s = 0; s < n; ++s) {
+                Slot& slot = timetable[sessions[s]];
+                if (roomOf[s] >= 0) {
+                    slot.room = rooms[roomOf[s]];
+                } else {
+                    std::cerr << "Warning: No room left for \"" << slot.subject << "\" at day "
+                              << day << ", time " << time << "\n";
+                }
+            }
+        }
+    }
+}
+
+// Load config and sort subjects once; the result is shared by every solve
+SchedulerInput prepareInput(std::vector<Subject> subjects, const std::string& config_filename) {
+    SchedulerInput input;
+
+    // Load rooms (config may override the 5x6 default grid)
+    input.rooms = getRooms(config_filename, input.days_per_week, input.hours_per_day);
+    if (input.rooms.empty()) {
         // Already warned in getRooms; but ensure at least one default
-        rooms = {"Classroom1"};
+        input.rooms = {"Classroom1"};
     }
-    // Track morning slot usage per day
-    std::vector<int> usedMorningSlots(days_per_week, 0);
-    const int morningSlotCount = 3; // indices 0,1,2 => 9AM,10AM,11AM
-    const double distributionPenalty = 2.0;
+    // A room listed twice is still one room; capacity and matching count names
+    std::vector<std::string> uniqueRooms;
+    for (const auto& room : input.rooms) {
+        if (std::find(uniqueRooms.begin(), uniqueRooms.end(), room) == uniqueRooms.end()) {
+            uniqueRooms.push_back(room);
+        } else {
+            std::cerr << "Warning: Room '" << room << "' is listed more than once in '"
+                      << config_filename << "'. Counting it once.\n";
+        }
+    }
+    input.rooms = std::move(uniqueRooms);
 
     // Optional pre-check: total required hours vs total available slots
     int totalRequired = 0;
     for (auto& sub : subjects) {
         totalRequired += sub.hours_needed;
     }
-    int numRooms = (int)rooms.size();
-    int totalSlots = days_per_week * hours_per_day * numRooms;
+    for (const auto& room : input.rooms) {
+        if (isLabRoom(room)) ++input.capacity.lab;
+        else ++input.capacity.classroom;
+    }
+    int numRooms = (int)input.rooms.size();
+    int totalSlots = input.days_per_week * input.hours_per_day * numRooms;
     if (totalRequired > totalSlots) {
-        int diff = totalRequired - totalSlots;
+        input.overflowHours = totalRequired - totalSlots;
         std::cerr << "Error: Total required hours (" << totalRequired 
                   << ") exceed total available slots (" << totalSlots 
-                  << "). Unavoidable conflict of " << diff << " hour(s).\n";
-        // Record as a general conflict entry
-        conflicts.push_back({ "<TOTAL_OVERFLOW>", diff });
+                  << "). Unavoidable conflict of " << input.overflowHours << " hour(s).\n";
         // Continue best-effort scheduling
     }
 
@@ -314,47 +633,172 @@ ScheduleResult scheduleTimetable(std::vector<Subject>& subjects, const std::stri
     // 4️⃣ Final tie-breaker: alphabetically by subject name
     return a.name < b.name;
 });
+    input.subjects = std::move(subjects);
+
+    // Intern teachers and semesters so solves can index bookings by id
+    std::map<std::string, int> teacherIds, semesterIds;
+    for (const auto& sub : input.subjects) {
+        auto t = teacherIds.emplace(sub.teacher, (int)teacherIds.size()).first;
+        auto m = semesterIds.emplace(sub.semester, (int)semesterIds.size()).first;
+        input.teacherOf.push_back(t->second);
+        input.semesterOf.push_back(m->second);
+    }
+    input.teacherCount = (int)teacherIds.size();
+    input.semesterCount = (int)semesterIds.size();
+    return input;
+}
+
+// Candidate passes are cut into fixed blocks of periods; each block keeps its
+// own best candidate and score stats. Grids smaller than the threshold are
+// evaluated serially, since each period check is only a few lookups.
+const int kCandidateBlock = 256;
+const int kParallelCandidatePeriods = 2048;
+
+// Best candidate and score stats of one block of periods
+struct CandidateBlock {
+    int best = -1;       // period index, -1 if none feasible
+    int feasible = 0;
+    HeatmapStats stats;
+};
+
+// Greedy algorithm to schedule timetable with morning preference and conflict tracking.
+// Only reads `input`, so several settings can be solved concurrently. With a
+// pool, large candidate passes are spread over its workers; the result is
+// identical to a serial run.
+ScheduleResult scheduleTimetable(const SchedulerInput& input, const SolveSettings& settings = SolveSettings(),
+                                 ThreadPool* pool = nullptr) {
+    ScheduleResult result;
+    auto& timetable = result.timetable;
+    auto& conflicts = result.conflicts;
+    // 👈 added for heatmap
+    std::vector<std::tuple<std::string, std::string, std::string, double>> heatmapData;
 
 
+    // Define days and times
+    std::vector<std::string> days = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday"};
+    std::vector<std::string> times = {"9AM", "10AM", "11AM", "12PM", "1PM", "2PM"};
+    const std::vector<std::string>& rooms = input.rooms;
+    const int days_per_week = input.days_per_week;
+    const int hours_per_day = input.hours_per_day;
+    // Config may ask for a larger grid than the names above cover
+    for (int d = (int)days.size(); d < days_per_week; ++d) days.push_back(std::to_string(d));
+    for (int t = (int)times.size(); t < hours_per_day; ++t) times.push_back(std::to_string(t));
+    const double morningWeight = settings.morningWeight;
+
+    const RoomCapacity& capacity = input.capacity;
+    // Sessions per (day, time); rooms are only picked once every subject is placed
+    const int periods = days_per_week * hours_per_day;
+    std::vector<PeriodLoad> loads(periods);
+    PeriodBookings bookings(periods, input.teacherCount, input.semesterCount);
+    // Subject behind each timetable entry, parallel to `timetable`
+    std::vector<const Subject*> placedBy;
+    // Per-period candidate scores, refilled for every hour placed
+    std::vector<double> cellScores(periods, 0.0);
+    std::vector<char> feasible(periods, 0);
+    const int blockCount = (periods + kCandidateBlock - 1) / kCandidateBlock;
+    std::vector<CandidateBlock> blocks(blockCount);
+    const bool parallel = pool && periods >= kParallelCandidatePeriods;
+    // Track morning slot usage per day
+    std::vector<int> usedMorningSlots(days_per_week, 0);
+    const int morningSlotCount = 3; // indices 0,1,2 => 9AM,10AM,11AM
+    const double distributionPenalty = settings.distributionPenalty;
+
+    if (input.overflowHours > 0) {
+        // Record as a general conflict entry
+        conflicts.push_back({ "<TOTAL_OVERFLOW>", input.overflowHours });
+    }
+
     // Main scheduling loop
-    for (auto& sub : subjects) {
+    for (size_t si = 0; si < input.subjects.size(); ++si) {
+        const Subject& sub = input.subjects[si];
+        const int teacher = input.teacherOf[si];
+        const int semester = input.semesterOf[si];
         int hours_assigned = 0; 
         while (hours_assigned < sub.hours_needed) {
-            std::vector<SlotScore> candidateSlots;
-            // Generate and score all feasible slots
-            for (int day = 0; day < days_per_week; ++day) {
-                for (int time = 0; time < hours_per_day; ++time) {
-                    for (const auto& room : rooms) {
-                        Slot slot = { day, time, room, sub.name, sub.teacher, sub.semester };
-                        if (!isValidSlot(sub, slot, timetable)) continue;
-                        double score = 0.0;
-                        // Morning preference
-                        bool isMorning = (time < morningSlotCount);
-                        if (isMorning) {
-                            score += morningWeight;
-                            // Distribution penalty: fewer on already-used days
-                            score -= distributionPenalty * usedMorningSlots[day];
-                        }
-                        // Lab preference: consecutive availability
-                        if (sub.type == "Lab" && time < hours_per_day - 1) {
-                            Slot next_slot = { day, time + 1, room, sub.name, sub.teacher, sub.semester };
-                            if (isValidSlot(sub, next_slot, timetable)) {
-                                score += 3.0; // bonus for consecutive
-                            }
+            const std::string roomType = roomTypeLabel(sub);
+            // Score one block of periods; only reads the solver state, so blocks
+            // can be evaluated on any thread
+            auto evaluateBlock = [&](int b) {
+                CandidateBlock& block = blocks[b];
+                block = CandidateBlock();
+                int end = std::min(periods, (b + 1) * kCandidateBlock);
+                for (int p = b * kCandidateBlock; p < end; ++p) {
+                    feasible[p] = 0;
+                    if (!isValidPeriod(sub, teacher, semester, p, bookings, loads[p], capacity)) continue;
+                    int day = p / hours_per_day, time = p % hours_per_day;
+                    double score = 0.0;
+                    // Morning preference
+                    bool isMorning = (time < morningSlotCount);
+                    if (isMorning) {
+                        score += morningWeight;
+                        // Distribution penalty: fewer on already-used days
+                        score -= distributionPenalty * usedMorningSlots[day];
+                    }
+                    // Lab preference: consecutive availability
+                    if (sub.type == "Lab" && time < hours_per_day - 1) {
+                        if (isValidPeriod(sub, teacher, semester, p + 1, bookings, loads[p + 1], capacity)) {
+                            score += 3.0; // bonus for consecutive
                         }
-                        // 👈 added for heatmap
-                        // heatmapData.push_back({days[day], times[time], room, score});
-                        heatmapData.push_back(std::make_tuple(days[day], times[time], room, score));
-
+                    }
+                    cellScores[p] = score;
+                    feasible[p] = 1;
+                    ++block.feasible;
+                    block.stats.add(score);
+                    // Strictly higher only: ties stay on the earlier period
+                    if (block.best < 0 || score > cellScores[block.best]) block.best = p;
+                }
+            };
+            // Generate and score all feasible periods
+            if (parallel) {
+                pool->parallelFor(blockCount, evaluateBlock);
+            } else {
+                for (int b = 0; b < blockCount; ++b) evaluateBlock(b);
+            }
 
-                        candidateSlots.push_back({slot, score});
+            // Reduce blocks in (day, time) order: a later block only wins on a
+            // strictly higher score, so ties resolve to the earlier day, then
+            // earlier time, whatever thread scored the block
+            int bestPeriod = -1;
+            for (const auto& block : blocks) {
+                result.heatmapStats.merge(block.stats);
+                if (block.best >= 0 && (bestPeriod < 0 || cellScores[block.best] > cellScores[bestPeriod]))
+                    bestPeriod = block.best;
+            }
+            // 👈 added for heatmap
+            if (settings.recordHeatmap) {
+                std::vector<size_t> offset(blockCount);
+                size_t total = heatmapData.size();
+                for (int b = 0; b < blockCount; ++b) {
+                    offset[b] = total;
+                    total += blocks[b].feasible;
+                }
+                heatmapData.resize(total);
+                auto writeBlock = [&](int b) {
+                    size_t at = offset[b];
+                    int end = std::min(periods, (b + 1) * kCandidateBlock);
+                    for (int p = b * kCandidateBlock; p < end; ++p) {
+                        if (!feasible[p]) continue;
+                        int day = p / hours_per_day, time = p % hours_per_day;
+                        heatmapData[at++] = std::make_tuple(days[day], times[time], roomType, cellScores[p]);
                     }
+                };
+                if (parallel) {
+                    pool->parallelFor(blockCount, writeBlock);
+                } else {
+                    for (int b = 0; b < blockCount; ++b) writeBlock(b);
                 }
             }
-            if (candidateSlots.empty()) {
+
+            SlotScore best = { Slot{ -1, -1, "", sub.name, sub.teacher, sub.semester }, 0.0 };
+            if (bestPeriod >= 0) {
+                best.slot.day = bestPeriod / hours_per_day;
+                best.slot.time = bestPeriod % hours_per_day;
+                best.score = cellScores[bestPeriod];
+            }
+            if (best.slot.day < 0) {
     int remaining = sub.hours_needed - hours_assigned;
 
-    auto stats = analyzeSlotFailures(sub, timetable, rooms,days_per_week,hours_per_day);
+    auto stats = analyzeSlotFailures(sub, teacher, semester, rooms, bookings, loads, capacity, days_per_week, hours_per_day);
 
     std::string suggestion;
 
@@ -385,35 +829,30 @@ suggestion += ss.str();
 
 
     conflicts.push_back({ sub.name, remaining, suggestion });
+    result.unscheduledHours += remaining;
                 // std::cerr << "Warning: Could not schedule " << remaining 
                 //           << " hour(s) for subject \"" << sub.name << "\"\n";
                 // conflicts.push_back({ sub.name, remaining });
                 break; // move to next subject
             }
-            // Pick best-scoring slot - changed the lambda fxn
-          std::sort(candidateSlots.begin(), candidateSlots.end(),
-             [](const SlotScore& a, const SlotScore& b) {
-            if (a.score != b.score)
-                return a.score > b.score;  // higher score first
-            if (a.slot.day != b.slot.day)
-                return a.slot.day < b.slot.day;  // earlier day
-            if (a.slot.time != b.slot.time)
-                return a.slot.time < b.slot.time;  // earlier time
-            return a.slot.room < b.slot.room;  // alphabetical room
-        });
-
-
-            Slot bestSlot = candidateSlots[0].slot;
+            Slot bestSlot = best.slot;
             timetable.push_back(bestSlot);
+            placedBy.push_back(&sub);
+            addToPeriod(sub, loads[bestPeriod]);
+            bookings.book(bestPeriod, teacher, semester, (int)timetable.size() - 1);
             ++hours_assigned;
             if (bestSlot.time < morningSlotCount) {
                 usedMorningSlots[bestSlot.day]++;
             }
             // If Lab and still need hours, try consecutive slot
             if (sub.type == "Lab" && hours_assigned < sub.hours_needed && bestSlot.time < hours_per_day - 1) {
-                Slot next_slot = { bestSlot.day, bestSlot.time + 1, bestSlot.room, sub.name, sub.teacher, sub.semester };
-                if (isValidSlot(sub, next_slot, timetable)) {
+                Slot next_slot = { bestSlot.day, bestSlot.time + 1, "", sub.name, sub.teacher, sub.semester };
+                const int nextPeriod = bestPeriod + 1;
+                if (isValidPeriod(sub, teacher, semester, nextPeriod, bookings, loads[nextPeriod], capacity)) {
                     timetable.push_back(next_slot);
+                    placedBy.push_back(&sub);
+                    addToPeriod(sub, loads[nextPeriod]);
+                    bookings.book(nextPeriod, teacher, semester, (int)timetable.size() - 1);
                     ++hours_assigned;
                     if (next_slot.time < morningSlotCount) {
                         usedMorningSlots[next_slot.day]++;
@@ -421,30 +860,239 @@ suggestion += ss.str();
                 }
             }
         }
-        if (hours_assigned < sub.hours_needed) {
+        if (settings.verbose && hours_assigned < sub.hours_needed) {
             std::cerr << "Warning: Assigned " << hours_assigned << "/" 
                       << sub.hours_needed << " hour(s) for \"" << sub.name << "\"\n";
         }
     }
 
-    // Print morning slot distribution summary (for logging/debug)
-    std::cerr << "Morning slot distribution: ";
-    for (int i = 0; i < days_per_week; ++i) {
-        std::cerr << days[i] << ":" << usedMorningSlots[i] << " ";
-    }
-    std::cerr << "\n";
+    // Second phase: concrete rooms, one bipartite matching per period
+    assignRooms(timetable, placedBy, rooms, days_per_week, hours_per_day);
+
     // 👈 added for heatmap
     result.heatmap = std::move(heatmapData);
+    result.morningDistribution = std::move(usedMorningSlots);
 
     return result;
 }
 
+// Parse one finite sweep number; trailing garbage is an error
+double parseSweepNumber(const std::string& token) {
+    size_t used = 0;
+    double value = std::stod(token, &used);
+    if (used != token.size() || !std::isfinite(value))
+        throw std::invalid_argument("bad number '" + token + "'");
+    return value;
+}
+
+// Parse a sweep axis: either a comma list ("0,5,10") or a range "start:end:step".
+// Axes longer than maxValues are rejected before anything is allocated.
+std::vector<double> parseSweepValues(const std::string& spec, size_t maxValues) {
+    std::vector<double> values;
+    if (spec.find(':') != std::string::npos) {
+        std::vector<std::string> fields;
+        std::stringstream ss(spec);
+        std::string token;
+        while (std::getline(ss, token, ':')) fields.push_back(token);
+        if (fields.size() != 3)
+            throw std::invalid_argument("range must be start:end:step");
+        double start = parseSweepNumber(fields[0]);
+        double end = parseSweepNumber(fields[1]);
+        double step = parseSweepNumber(fields[2]);
+        if (step <= 0.0 || end < start)
+            throw std::invalid_argument("range must be start:end:step with step > 0 and end >= start");
+        double count = std::floor((end - start) / step + 1e-9) + 1.0;
+        if (!std::isfinite(count) || count > (double)maxValues)
+            throw std::invalid_argument("range '" + spec + "' has more than " + std::to_string(maxValues) + " values");
+        for (int i = 0; i < (int)count; ++i) values.push_back(start + i * step);
+    } else {
+        std::stringstream ss(spec);
+        std::string token;
+        while (std::getline(ss, token, ',')) {
+            if (token.empty()) continue;
+            if (values.size() == maxValues)
+                throw std::invalid_argument("list '" + spec + "' has more than " + std::to_string(maxValues) + " values");
+            values.push_back(parseSweepNumber(token));
+        }
+    }
+    if (values.empty())
+        throw std::invalid_argument("no values in '" + spec + "'");
+    return values;
+}
+
+// One sweep setting and its compact outcome
+struct SweepEntry {
+    SolveSettings settings;
+    int unscheduledHours = 0;
+    int morningHours = 0;     // total morning slots used
+    int morningSpread = 0;    // busiest minus quietest day
+    std::vector<int> morningDistribution;
+    HeatmapStats heatmapStats;
+    bool pareto = false;
+    bool selected = false;
+    std::vector<Slot> timetable;
+};
+
+// Pareto front over: fewer unscheduled hours, more morning hours, flatter spread
+void markParetoFront(std::vector<SweepEntry>& entries) {
+    for (auto& e : entries) {
+        e.pareto = true;
+        for (const auto& o : entries) {
+            bool noWorse = o.unscheduledHours <= e.unscheduledHours &&
+                           o.morningHours >= e.morningHours &&
+                           o.morningSpread <= e.morningSpread;
+            bool better = o.unscheduledHours < e.unscheduledHours ||
+                          o.morningHours > e.morningHours ||
+                          o.morningSpread < e.morningSpread;
+            if (noWorse && better) {
+                e.pareto = false;
+                break;
+            }
+        }
+    }
+}
+
+// Solve every (morningWeight, distributionPenalty) pair against one shared input
+std::vector<SweepEntry> runSweep(const SchedulerInput& input,
+                                 const std::vector<double>& weights,
+                                 const std::vector<double>& penalties) {
+    std::vector<SweepEntry> entries;
+    for (double w : weights) {
+        for (double p : penalties) {
+            SweepEntry e;
+            e.settings.morningWeight = w;
+            e.settings.distributionPenalty = p;
+            e.settings.recordHeatmap = false;
+            e.settings.verbose = false;
+            entries.push_back(e);
+        }
+    }
+
+    ThreadPool pool(std::min<unsigned>(defaultThreadCount(), (unsigned)entries.size()));
+    pool.parallelFor((int)entries.size(), [&](int i) {
+        SweepEntry& e = entries[i];
+        // Settings already fill the pool, so each solve runs serially
+        ScheduleResult res = scheduleTimetable(input, e.settings);
+        e.unscheduledHours = res.unscheduledHours;
+        e.morningDistribution = res.morningDistribution;
+        e.heatmapStats = res.heatmapStats;
+        e.timetable = std::move(res.timetable);
+        if (!e.morningDistribution.empty()) {
+            auto mm = std::minmax_element(e.morningDistribution.begin(), e.morningDistribution.end());
+            e.morningSpread = *mm.second - *mm.first;
+        }
+        for (int used : e.morningDistribution) e.morningHours += used;
+    });
+
+    markParetoFront(entries);
+    return entries;
+}
+
+// Helper: convert sweep summaries to a JSON array; timetables only for selected entries
+std::string sweepToJsonArray(const std::vector<SweepEntry>& entries) {
+    std::vector<std::string> days = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday"};
+    std::string json = "[\n";
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const SweepEntry& e = entries[i];
+        json += "    {\"index\":" + std::to_string(i) + ",";
+        json += "\"morningWeight\":" + std::to_string(e.settings.morningWeight) + ",";
+        json += "\"distributionPenalty\":" + std::to_string(e.settings.distributionPenalty) + ",";
+        json += "\"unscheduledHours\":" + std::to_string(e.unscheduledHours) + ",";
+        json += "\"morningHours\":" + std::to_string(e.morningHours) + ",";
+        json += "\"morningSpread\":" + std::to_string(e.morningSpread) + ",";
+        json += "\"morningDistribution\":{";
+        for (size_t d = 0; d < e.morningDistribution.size(); ++d) {
+            std::string dayStr = d < days.size() ? days[d] : std::to_string(d);
+            json += "\"" + dayStr + "\":" + std::to_string(e.morningDistribution[d]);
+            if (d + 1 < e.morningDistribution.size()) json += ",";
+        }
+        json += "},";
+        json += "\"heatmap\":{\"count\":" + std::to_string(e.heatmapStats.count) +
+                ",\"min\":" + std::to_string(e.heatmapStats.min) +
+                ",\"max\":" + std::to_string(e.heatmapStats.max) +
+                ",\"mean\":" + std::to_string(e.heatmapStats.mean()) + "},";
+        json += std::string("\"pareto\":") + (e.pareto ? "true" : "false");
+        if (e.selected)
+            json += ",\"timetable\":" + timetableToJsonArray(e.timetable);
+        json += "}";
+        if (i + 1 < entries.size()) json += ",";
+        json += "\n";
+    }
+    json += "  ]";
+    return json;
+}
+
+// Sweep mode: parse and index once, solve every setting on a thread pool
+int runSweepMode(const std::vector<Subject>& subjects, const std::string& config_filename,
+                 const std::string& weightSpec, const std::string& penaltySpec,
+                 const std::string& selectSpec) {
+    const size_t maxSettings = 1024;
+    std::vector<double> weights, penalties;
+    try {
+        weights = parseSweepValues(weightSpec, maxSettings);
+        penalties = parseSweepValues(penaltySpec, maxSettings);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: Invalid sweep values (" << e.what() << ").\n";
+        return 1;
+    }
+    if (weights.size() * penalties.size() > maxSettings) {
+        std::cerr << "Error: Sweep has " << weights.size() * penalties.size()
+                  << " settings; at most " << maxSettings << " are allowed.\n";
+        return 1;
+    }
+
+    SchedulerInput input = prepareInput(subjects, config_filename);
+    std::vector<SweepEntry> entries = runSweep(input, weights, penalties);
+
+    // Which settings carry a full timetable: pareto (default), all, none, or index list
+    if (selectSpec == "all") {
+        for (auto& e : entries) e.selected = true;
+    } else if (selectSpec.empty() || selectSpec == "pareto") {
+        for (auto& e : entries) e.selected = e.pareto;
+    } else if (selectSpec != "none") {
+        std::stringstream ss(selectSpec);
+        std::string token;
+        while (std::getline(ss, token, ',')) {
+            try {
+                int idx = std::stoi(token);
+                if (idx >= 0 && idx < (int)entries.size()) entries[idx].selected = true;
+            } catch (...) {
+                std::cerr << "Warning: Ignoring invalid sweep selection '" << token << "'\n";
+            }
+        }
+    }
+
+    std::string json = "{\n";
+    json += "  \"sweep\": " + sweepToJsonArray(entries) + "\n";
+    json += "}\n";
+    std::cout << json;
+
+    int paretoCount = 0;
+    for (const auto& e : entries) paretoCount += e.pareto ? 1 : 0;
+    std::cerr << "Sweep complete. Settings: " << entries.size()
+              << ". Pareto-optimal: " << paretoCount << ".\n";
+    return 0;
+}
+
 // Main: parse args, read data, schedule, output JSON (timetable + conflicts)
 int main(int argc, char* argv[]) {
-    if (argc < 3 || argc > 4) {
+    // Sweep mode: <dataset.csv> <config.csv> --sweep <weights> <penalties> [select]
+    bool sweep = argc >= 4 && std::string(argv[3]) == "--sweep";
+    if (sweep && argc >= 6 && argc <= 7) {
+        std::vector<Subject> subjects = readSubjects(argv[1]);
+        if (subjects.empty()) {
+            std::cerr << "No subjects loaded from '" << argv[1] << "'. Exiting.\n";
+            return 1;
+        }
+        return runSweepMode(subjects, argv[2], argv[4], argv[5], argc == 7 ? argv[6] : "pareto");
+    }
+    if (sweep || argc < 3 || argc > 4) {
         std::cerr << "Usage: " << argv[0] << " <dataset.csv> <config.csv> [morningWeight]\n";
+        std::cerr << "       " << argv[0] << " <dataset.csv> <config.csv> --sweep <morningWeights> <penalties> [pareto|all|none|i,j,...]\n";
         std::cerr << "Example: " << argv[0] << " dataset.csv resources.csv 10.0\n";
+        std::cerr << "Example: " << argv[0] << " dataset.csv resources.csv --sweep 0:20:2.5 1,2,4\n";
         std::cerr << "Morning weight controls preference for morning slots (0-20, default: 5.0)\n";
+        std::cerr << "Sweep values are a comma list or start:end:step; the last argument picks which settings include a full timetable\n";
         return 1;
     }
     // Parse optional morningWeight
@@ -470,7 +1118,23 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     // Schedule
-    ScheduleResult res = scheduleTimetable(subjects, argv[2], morningWeight);
+    SchedulerInput input = prepareInput(std::move(subjects), argv[2]);
+    SolveSettings settings;
+    settings.morningWeight = morningWeight;
+    // Only grids large enough for a parallel candidate pass get worker threads
+    std::unique_ptr<ThreadPool> pool;
+    unsigned threads = defaultThreadCount();
+    if (threads > 1 && input.days_per_week * input.hours_per_day >= kParallelCandidatePeriods)
+        pool.reset(new ThreadPool(threads));
+    ScheduleResult res = scheduleTimetable(input, settings, pool.get());
+
+    // Print morning slot distribution summary (for logging/debug)
+    std::vector<std::string> days = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday"};
+    std::cerr << "Morning slot distribution: ";
+    for (size_t i = 0; i < res.morningDistribution.size(); ++i) {
+        std::cerr << (i < days.size() ? days[i] : std::to_string(i)) << ":" << res.morningDistribution[i] << " ";
+    }
+    std::cerr << "\n";
 
     // Build JSON output
     std::string json = "{\n";